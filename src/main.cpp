@@ -43,6 +43,30 @@ static int currentGas = 0;           // Gaz: 0-100%
 static bool isBraking = false;       // Fren durumu
 static int brakeIntensity = 100;     // Fren yoğunluğu: 0-100%
 
+// Komut gecikmesi: istemci `ts` parametresini cihaz saatine (millis) çevirip gönderir
+// Saat farkı /api/ping ile NTP tarzı hesaplanır
+static const long MAX_COMMAND_AGE_MS = 500;  // Bundan eski komutlar reddedilir
+
+// Yük testi istatistikleri (/api/stats)
+static uint32_t minFreeHeap = 0xFFFFFFFF;  // En düşük boş heap (high-water mark)
+static uint32_t handledRequests = 0;       // İşlenen kontrol komutu sayısı
+static uint32_t handleUsTotal = 0;         // Kontrol komutlarının toplam işlenme süresi (µs)
+static uint32_t handleUsMax = 0;           // En uzun işlenme süresi (µs)
+
+// Sürücü kiralaması (lease): aynı anda tek istemci sürer
+// İstemci `client` parametresi ile kimliğini (sıfırdan farklı sayı) gönderir
+static const unsigned long LEASE_TTL_MS = 2000;  // Yenilenmezse bu sürede düşer
+static uint32_t leaseHolder = 0;                 // 0 = kimse sürmüyor
+static int leasePriority = 0;                    // Yüksek öncelik mevcut sürücüyü devralır
+static unsigned long leaseExpiresAt = 0;
+static unsigned long leaseFreeSince = 0;         // Lease boşaldığı an (devir süresi için)
+static uint32_t lastLeaseHolder = 0;             // Son sürücü (lease düştükten sonra da tutulur)
+static uint32_t rejectedCommands = 0;            // Sürücü olmayanlardan reddedilen komutlar
+static uint32_t leaseDenials = 0;                // Reddedilen lease istekleri (izleyici yoklamaları)
+static uint32_t leaseHandovers = 0;              // Sürücü değişim sayısı
+static unsigned long lastHandoverMs = 0;         // Son devirde lease'in boş kaldığı süre
+static uint32_t brakeOwner = 0;                  // Freni basan istemci (sürücü olmasa da bırakabilir)
+
 // Yardımcı: sınırla
 static int clampInt(int value, int minVal, int maxVal) {
   if (value < minVal) return minVal;
@@ -50,6 +74,78 @@ static int clampInt(int value, int minVal, int maxVal) {
   return value;
 }
 
+// Yardımcı: cevap gönder ve heap high-water mark'ı örnekle
+// Örnek, istek String'leri ve cevap gövdesi henüz bellekteyken alınır
+static void sendResponse(int code, const char* contentType, const String& body) {
+  uint32_t freeHeap = ESP.getFreeHeap();
+  if (freeHeap < minFreeHeap) minFreeHeap = freeHeap;
+  server.send(code, contentType, body);
+}
+
+// Yardımcı: komut yaşını kontrol et (ts yoksa kontrol yapılmaz)
+// Geçersiz ts ise 400, eski komut ise 409 döner ve false verir
+static bool checkCommandAge(unsigned long receivedAt) {
+  if (!server.hasArg("ts")) return true;
+
+  const String tsArg = server.arg("ts");
+  char* end = nullptr;
+  unsigned long clientTs = strtoul(tsArg.c_str(), &end, 10);
+  if (tsArg.length() == 0 || *end != '\0') {
+    sendResponse(400, "text/plain", "invalid ts");
+    return false;
+  }
+  long age = (long)(receivedAt - clientTs);  // millis taşmasına karşı işaretli fark
+
+  Serial.print("Gecikme: ");
+  Serial.print(age);
+  Serial.println(" ms");
+
+  if (age > MAX_COMMAND_AGE_MS) {
+    Serial.println("Eski komut reddedildi");
+    sendResponse(409, "text/plain", "STALE");
+    return false;
+  }
+  return true;
+}
+
+// Yardımcı: süresi dolan lease'i düşür, aktif sürücü var mı döner
+static bool leaseActive(unsigned long now) {
+  if (leaseHolder == 0) return false;
+  if ((long)(now - leaseExpiresAt) < 0) return true;
+
+  Serial.print("Lease süresi doldu: ");
+  Serial.println(leaseHolder);
+  leaseHolder = 0;
+  leaseFreeSince = leaseExpiresAt;
+  return false;
+}
+
+// Yardımcı: istekteki istemci kimliği (yoksa 0)
+static uint32_t requestClient() {
+  return server.hasArg("client") ? strtoul(server.arg("client").c_str(), nullptr, 10) : 0;
+}
+
+// Yardımcı: komut sahibini kontrol et (pin işlemlerinden önce çağrılır)
+// Aktif lease varsa sadece sahibi komut gönderebilir
+// Sahibi değilse 423 döner ve false verir
+static bool checkLease() {
+  if (!leaseActive(millis())) return true;
+  if (requestClient() == leaseHolder) return true;
+
+  rejectedCommands++;
+  sendResponse(423, "text/plain", "LOCKED");
+  return false;
+}
+
+// Yardımcı: sürücünün kabul edilen komutu lease'i yeniler
+// Tüm kontroller (yaş vb.) geçildikten sonra çağrılır
+static void touchLease() {
+  unsigned long now = millis();
+  if (leaseActive(now) && requestClient() == leaseHolder) {
+    leaseExpiresAt = now + LEASE_TTL_MS;
+  }
+}
+
 
 // HTML sayfa (RC Car kumanda arayüzü - Sade Tasarım)
 static const char HTML_PAGE[] PROGMEM = R"HTML(
@@ -274,6 +370,96 @@ static const char HTML_PAGE[] PROGMEM = R"HTML(
   <script>
     let currentGear = 'N';
     let currentGas = 0;
+    let clockOffset = null;  // cihaz saati - istemci saati (ms)
+    
+    // Saat farkını ölç (NTP tarzı: t0 gönder, rx/tx al, t3 ölç)
+    // Birkaç örnek alınır, en düşük RTT'li örneğin farkı kullanılır
+    const PING_SAMPLES = 5;
+    async function syncClock() {
+      let bestRtt = Infinity;
+      let bestOffset = null;
+      for (let i = 0; i < PING_SAMPLES; i++) {
+        try {
+          const t0 = Date.now();
+          const response = await fetch('/api/ping');
+          const t3 = Date.now();
+          const p = await response.json();
+          const rtt = (t3 - t0) - (p.tx - p.rx);
+          if (rtt < bestRtt) {
+            bestRtt = rtt;
+            bestOffset = Math.round(((p.rx - t0) + (p.tx - t3)) / 2);
+          }
+        } catch (e) {
+          console.error('Ping error:', e);
+        }
+      }
+      if (bestOffset !== null) {
+        clockOffset = bestOffset;
+        console.log('RTT:', bestRtt, 'ms, offset:', clockOffset, 'ms');
+      }
+    }
+    
+    // Komutlara cihaz saatine göre zaman damgası ekle
+    function tsParam() {
+      return clockOffset === null ? '' : '&ts=' + (Date.now() + clockOffset);
+    }
+    
+    // Sürücü kiralaması: sekme başına rastgele kimlik
+    // İlk sürüş hareketinde alınır, 1 sn'de bir yenilenir (TTL 2 sn)
+    // 5 sn sürüş hareketi olmazsa veya sayfa kapanınca bırakılır
+    const clientId = 1 + Math.floor(Math.random() * 4294967294);
+    const LEASE_IDLE_MS = 5000;
+    let leaseTimer = null;
+    let leasePending = null;
+    let lastDriveInput = 0;
+    
+    async function renewLease() {
+      let held = false;
+      try {
+        const response = await fetch('/api/lease?client=' + clientId);
+        held = response.ok;
+      } catch (e) {
+        console.error('Lease error:', e);
+      }
+      document.getElementById('lease').textContent =
+        held ? '🎮 Sürücü' : '👀 İzleyici (başka sürücü aktif)';
+      if (!held && leaseTimer) {
+        clearInterval(leaseTimer);
+        leaseTimer = null;
+      }
+      return held;
+    }
+    
+    // Boşta kalan sekme lease'i tutmaz (fren basılıyken boşta sayılmaz)
+    function leaseTick() {
+      if (!brakeActive && Date.now() - lastDriveInput > LEASE_IDLE_MS) {
+        releaseLease();
+      } else {
+        renewLease();
+      }
+    }
+    
+    function releaseLease() {
+      if (!leaseTimer) return;
+      clearInterval(leaseTimer);
+      leaseTimer = null;
+      fetch('/api/lease?client=' + clientId + '&release=1', { keepalive: true });
+      document.getElementById('lease').textContent = '';
+    }
+    
+    // Her sürüş hareketinde çağrılır: sürücü değilse lease almayı dener, sürücü ise true döner
+    async function ensureLease() {
+      lastDriveInput = Date.now();
+      if (leaseTimer) return true;
+      if (!leasePending) {
+        leasePending = renewLease().finally(() => { leasePending = null; });
+      }
+      const held = await leasePending;
+      if (held && !leaseTimer) leaseTimer = setInterval(leaseTick, 1000);
+      return held;
+    }
+    
+    window.addEventListener('pagehide', releaseLease);
     
     // Vites değiştir
     async function changeGear(gear) {
@@ -299,8 +485,12 @@ static const char HTML_PAGE[] PROGMEM = R"HTML(
         speed = -Math.round(currentGas * 2.55); // 0-100 -> 0 to -255
       }
       
+      if (!(await ensureLease())) return;
       try {
-        await fetch('/api/mosfet?duty=' + speed);
+        const response = await fetch('/api/mosfet?duty=' + speed + '&client=' + clientId + tsParam());
+        const status = await response.text();
+        // Fren başka istemciden basılmış olabilir: durumu göster
+        showBrake(brakeActive || status === 'BRAKING');
       } catch (e) {
         console.error('Motor error:', e);
       }
@@ -308,27 +498,37 @@ static const char HTML_PAGE[] PROGMEM = R"HTML(
     
     // Direksiyon
     async function updateSteering(angle) {
+      if (!(await ensureLease())) return;
       try {
-        await fetch('/api/servo?angle=' + angle);
+        await fetch('/api/servo?angle=' + angle + '&client=' + clientId + tsParam());
         document.getElementById('steerLabel').textContent = (angle-72) + '°';
       } catch (e) {
         console.error('Servo error:', e);
       }
     }
     
-    // Durdur
-    function emergencyStop() {
-      changeGear('N');
+    // Acil durdur (sürücü olmasa da motoru durdurur)
+    async function emergencyStop() {
+      currentGear = 'N';
+      currentGas = 0;
+      document.querySelectorAll('.gear-btn').forEach(btn => btn.classList.remove('active'));
+      document.getElementById('gearN').classList.add('active');
       document.getElementById('gasSlider').value = 0;
+      document.getElementById('gasLabel').textContent = '0%';
       document.getElementById('steerSlider').value = 72;
-      updateGas(0);
-      updateSteering(72);
+      try {
+        await fetch('/api/mosfet?duty=0&estop=1&client=' + clientId);
+      } catch (e) {
+        console.error('Motor error:', e);
+      }
+      if (leaseTimer) updateSteering(72);
     }
     
     // Ön far
     async function toggleHeadlight() {
+      if (!(await ensureLease())) return;
       try {
-        const response = await fetch('/api/headlight');
+        const response = await fetch('/api/headlight?client=' + clientId);
         const status = await response.text();
         const btn = document.getElementById('headlightBtn');
         if (status === 'ON') {
@@ -343,8 +543,9 @@ static const char HTML_PAGE[] PROGMEM = R"HTML(
     
     // Stop lambası
     async function toggleStopLight() {
+      if (!(await ensureLease())) return;
       try {
-        const response = await fetch('/api/stoplight');
+        const response = await fetch('/api/stoplight?client=' + clientId);
         const status = await response.text();
         const btn = document.getElementById('stopBtn');
         if (status === 'ON') {
@@ -359,23 +560,35 @@ static const char HTML_PAGE[] PROGMEM = R"HTML(
     
     // Fren (basılı tutma)
     let brakeActive = false;
+    function showBrake(on) {
+      const btn = document.getElementById('brakeBtn');
+      if (on) {
+        btn.classList.add('active');
+      } else {
+        btn.classList.remove('active');
+      }
+    }
+    
     async function applyBrake(pressed) {
+      // Basılmadan bırakma (örn. fare butonun üzerinden geçince) yok sayılır
+      if (!pressed && !brakeActive) return;
       brakeActive = pressed;
-      const btn = document.getElementById('brakeBtn');
+      if (leaseTimer) lastDriveInput = Date.now();
       
       if (pressed) {
-        btn.classList.add('active');
+        showBrake(true);
         try {
-          await fetch('/api/brake?state=1');
+          await fetch('/api/brake?state=1&client=' + clientId);
         } catch (e) {
           console.error('Brake error:', e);
         }
       } else {
-        btn.classList.remove('active');
+        showBrake(false);
         try {
-          await fetch('/api/brake?state=0');
-          // Fren bırakınca motor durumunu güncelle
-          updateMotor();
+          // Freni basan istemci sürücü olmasa da bırakabilir
+          const response = await fetch('/api/brake?state=0&client=' + clientId);
+          // Fren bırakınca motor durumunu güncelle (sadece sürücü)
+          if (response.ok && leaseTimer) updateMotor();
         } catch (e) {
           console.error('Brake error:', e);
         }
@@ -396,6 +609,8 @@ static const char HTML_PAGE[] PROGMEM = R"HTML(
     // Sayfa yüklendiğinde
     document.addEventListener('DOMContentLoaded', function() {
       loadVersion();
+      syncClock();
+      setInterval(syncClock, 30000);
     });
   </script>
 </head>
@@ -404,6 +619,7 @@ static const char HTML_PAGE[] PROGMEM = R"HTML(
     <div class="header">
       <h1>🏎️ RC Car Kumanda</h1>
       <div style="font-size: 0.8em; opacity: 0.7; margin-top: 5px;" id="version">Yükleniyor...</div>
+      <div style="font-size: 0.8em; opacity: 0.7; margin-top: 5px;" id="lease"></div>
     </div>
     
     <!-- Vites Seçici -->
@@ -464,10 +680,15 @@ static void handleRoot() {
 }
 
 static void handleServo() {
+  unsigned long receivedAt = millis();
+  handledRequests++;
   if (!server.hasArg("angle")) { 
-    server.send(400, "text/plain", "angle parameter missing"); 
+    sendResponse(400, "text/plain", "angle parameter missing"); 
     return; 
   }
+  if (!checkLease()) return;
+  if (!checkCommandAge(receivedAt)) return;
+  touchLease();
   
   int angle = clampInt(server.arg("angle").toInt(), SERVO_MIN_DEG, SERVO_MAX_DEG);
   steeringServo.write(angle);
@@ -477,22 +698,36 @@ static void handleServo() {
   Serial.print(angle - 72);
   Serial.println("°");
   
-  server.send(200, "text/plain", "OK");
+  sendResponse(200, "text/plain", "OK");
 }
 
 static void handleMosfet() {
+  unsigned long receivedAt = millis();
+  handledRequests++;
   if (!server.hasArg("duty")) { 
-    server.send(400, "text/plain", "duty parameter missing"); 
+    sendResponse(400, "text/plain", "duty parameter missing"); 
     return; 
   }
   
   // -255 ile +255 arası değer al (+ ileri, - geri)
   int speed = clampInt(server.arg("duty").toInt(), -255, 255);
+  
+  // Acil durdurma (estop=1) herkesten kabul edilir ve motoru durdurur
+  bool emergencyStop = server.hasArg("estop") && server.arg("estop").toInt() == 1;
+  if (emergencyStop) {
+    speed = 0;
+  } else if (!checkLease()) {
+    return;
+  }
+  
+  // Dur komutu gecikmiş olsa bile uygulanır (güvenlik)
+  if (speed != 0 && !checkCommandAge(receivedAt)) return;
+  touchLease();
   currentMotorSpeed = speed;
   
   // Fren aktifse motor kontrolünü engelle
   if (isBraking) {
-    server.send(200, "text/plain", "BRAKING");
+    sendResponse(200, "text/plain", "BRAKING");
     return;
   }
   
@@ -539,17 +774,29 @@ static void handleMosfet() {
     Serial.println(")");
   }
   
-  server.send(200, "text/plain", "OK");
+  sendResponse(200, "text/plain", "OK");
 }
 
 static void handleBrake() {
+  handledRequests++;
   if (!server.hasArg("state")) { 
-    server.send(400, "text/plain", "state parameter missing"); 
+    sendResponse(400, "text/plain", "state parameter missing"); 
     return; 
   }
   
   int state = server.arg("state").toInt();
+  
+  // Fren basma herkesten kabul edilir
+  // Bırakma sürücüden veya freni basan istemciden kabul edilir
+  uint32_t client = requestClient();
+  if (state == 1) {
+    brakeOwner = client;
+  } else if (!(isBraking && client != 0 && client == brakeOwner) && !checkLease()) {
+    return;
+  }
+  touchLease();
   isBraking = (state == 1);
+  if (!isBraking) brakeOwner = 0;
   
   if (isBraking) {
     // FREN AKTIF: Dinamik frenleme (motor kısa devre modu)
@@ -581,10 +828,13 @@ static void handleBrake() {
     Serial.println("FREN SERBEST");
   }
   
-  server.send(200, "text/plain", isBraking ? "BRAKING" : "RELEASED");
+  sendResponse(200, "text/plain", isBraking ? "BRAKING" : "RELEASED");
 }
 
 static void handleHeadlight() {
+  handledRequests++;
+  if (!checkLease()) return;
+  touchLease();
   // Toggle ön farlar
   headlightOn = !headlightOn;
   digitalWrite(HEADLIGHT_PIN, headlightOn ? HIGH : LOW);
@@ -592,10 +842,13 @@ static void handleHeadlight() {
   Serial.print("Ön farlar: ");
   Serial.println(headlightOn ? "AÇIK" : "KAPALI");
   
-  server.send(200, "text/plain", headlightOn ? "ON" : "OFF");
+  sendResponse(200, "text/plain", headlightOn ? "ON" : "OFF");
 }
 
 static void handleStopLight() {
+  handledRequests++;
+  if (!checkLease()) return;
+  touchLease();
   // Toggle stop lambası
   stopLightOn = !stopLightOn;
   digitalWrite(STOP_LED_PIN, stopLightOn ? HIGH : LOW);
@@ -603,12 +856,126 @@ static void handleStopLight() {
   Serial.print("Stop lambası: ");
   Serial.println(stopLightOn ? "AÇIK" : "KAPALI");
   
-  server.send(200, "text/plain", stopLightOn ? "ON" : "OFF");
+  sendResponse(200, "text/plain", stopLightOn ? "ON" : "OFF");
 }
 
 static void handleVersion() {
   String versionInfo = String(FIRMWARE_VERSION) + " | " + String(BUILD_DATE);
-  server.send(200, "text/plain", versionInfo);
+  sendResponse(200, "text/plain", versionInfo);
+}
+
+static void handleLease() {
+  unsigned long now = millis();
+  bool active = leaseActive(now);
+  
+  // client yoksa sadece durum okunur (izleyici)
+  if (server.hasArg("client")) {
+    uint32_t client = strtoul(server.arg("client").c_str(), nullptr, 10);
+    int prio = server.hasArg("prio") ? clampInt(server.arg("prio").toInt(), 0, 9) : 0;
+    
+    if (client == 0) {
+      sendResponse(400, "text/plain", "invalid client");
+      return;
+    }
+    
+    if (server.hasArg("release") && server.arg("release").toInt() == 1) {
+      if (active && client == leaseHolder) {
+        leaseHolder = 0;
+        leaseFreeSince = now;
+        Serial.print("Lease bırakıldı: ");
+        Serial.println(client);
+      }
+      sendResponse(200, "text/plain", "RELEASED");
+      return;
+    }
+    
+    if (active && client != leaseHolder && prio <= leasePriority) {
+      leaseDenials++;
+      sendResponse(423, "text/plain", "LOCKED");
+      return;
+    }
+    
+    if (client != leaseHolder) {
+      // Devir: sadece önceki bir sürücüden alınınca sayılır
+      // Boşta kalma süresi (öncelikle devralmada 0)
+      if (lastLeaseHolder != 0 && lastLeaseHolder != client) {
+        lastHandoverMs = active ? 0 : now - leaseFreeSince;
+        leaseHandovers++;
+      }
+      Serial.print("Yeni sürücü: ");
+      Serial.print(client);
+      Serial.print(" (öncelik ");
+      Serial.print(prio);
+      Serial.println(")");
+    }
+    
+    // Sürücü yenilerken önceliği korunur, sadece daha yüksek prio ile yükseltilir
+    if (client != leaseHolder || prio > leasePriority) leasePriority = prio;
+    leaseHolder = client;
+    lastLeaseHolder = client;
+    leaseExpiresAt = now + LEASE_TTL_MS;
+    active = true;
+  }
+  
+  String json = "{\"holder\":" + String(active ? leaseHolder : 0);
+  json += ",\"prio\":" + String(active ? leasePriority : 0);
+  json += ",\"ttl\":" + String(active ? leaseExpiresAt - now : 0);
+  json += "}";
+  sendResponse(200, "application/json", json);
+}
+
+static void handleState() {
+  // Sadece okuma - lease gerektirmez
+  String json = "{\"angle\":" + String(currentServoAngle);
+  json += ",\"speed\":" + String(currentMotorSpeed);
+  json += ",\"braking\":" + String(isBraking ? "true" : "false");
+  json += ",\"headlight\":" + String(headlightOn ? "true" : "false");
+  json += ",\"stoplight\":" + String(stopLightOn ? "true" : "false");
+  json += ",\"driver\":" + String(leaseActive(millis()) ? leaseHolder : 0);
+  json += "}";
+  sendResponse(200, "application/json", json);
+}
+
+static void handleStats() {
+  // Ölçüm penceresini sıfırla (replay başlangıcında kullanılır)
+  if (server.hasArg("reset") && server.arg("reset").toInt() == 1) {
+    minFreeHeap = ESP.getFreeHeap();
+    handledRequests = 0;
+    handleUsTotal = 0;
+    handleUsMax = 0;
+    rejectedCommands = 0;
+    leaseDenials = 0;
+    leaseHandovers = 0;
+    lastHandoverMs = 0;
+    // Sıfırlamadan sonraki ilk lease devir sayılmaz (aktif sürücü hariç)
+    lastLeaseHolder = leaseActive(millis()) ? leaseHolder : 0;
+  }
+  
+  String json = "{\"heap\":" + String(ESP.getFreeHeap());
+  json += ",\"heap_min\":" + String(minFreeHeap);
+  json += ",\"max_block\":" + String(ESP.getMaxFreeBlockSize());
+  json += ",\"frag\":" + String(ESP.getHeapFragmentation());
+  json += ",\"requests\":" + String(handledRequests);
+  json += ",\"handle_us_avg\":" + String(handledRequests ? handleUsTotal / handledRequests : 0);
+  json += ",\"handle_us_max\":" + String(handleUsMax);
+  json += ",\"rejected\":" + String(rejectedCommands);
+  json += ",\"lease_denied\":" + String(leaseDenials);
+  json += ",\"handovers\":" + String(leaseHandovers);
+  json += ",\"last_handover_ms\":" + String(lastHandoverMs);
+  json += ",\"uptime\":" + String(millis()) + "}";
+  sendResponse(200, "application/json", json);
+}
+
+static void handlePing() {
+  // rx: handler girişi, tx: gönderimden hemen önce (cihaz millis)
+  // Handler ms altında biter; rx ve tx çoğunlukla aynıdır, tek cihaz zamanı gibi kullanılabilir
+  unsigned long rx = millis();
+  
+  String json = "{\"rx\":" + String(rx) + ",\"tx\":";
+  json.reserve(json.length() + 12);
+  unsigned long tx = millis();
+  json += String(tx) + "}";
+  sendResponse(200, "application/json", json);
 }
 
 void setup() {
@@ -699,6 +1066,10 @@ void setup() {
   server.on("/api/headlight", HTTP_GET, handleHeadlight);
   server.on("/api/stoplight", HTTP_GET, handleStopLight);
   server.on("/api/version", HTTP_GET, handleVersion);
+  server.on("/api/ping", HTTP_GET, handlePing);
+  server.on("/api/stats", HTTP_GET, handleStats);
+  server.on("/api/lease", HTTP_GET, handleLease);
+  server.on("/api/state", HTTP_GET, handleState);
   server.begin();
   Serial.println("HTTP sunucu basladi");
   Serial.print("Firmware: ");
@@ -707,5 +1078,14 @@ void setup() {
 
 void loop() {
   ArduinoOTA.handle();
+  
+  // Kontrol komutu işlenme süresi: istek ayrıştırma + handler + cevap gönderimi
+  uint32_t requestsBefore = handledRequests;
+  unsigned long startUs = micros();
   server.handleClient();
+  if (handledRequests != requestsBefore) {
+    uint32_t elapsedUs = micros() - startUs;
+    handleUsTotal += elapsedUs;
+    if (elapsedUs > handleUsMax) handleUsMax = elapsedUs;
+  }
 }
\ No newline at end of file
@@ -0,0 +1,306 @@
+#!/usr/bin/env python3
+"""RC Car komut akışı kayıt / tekrar oynatma aracı (yük testi).
+
+Kullanım:
+  # Kayıt: tarayıcıyı http://localhost:8080 adresine bağlayın, araç gibi sürün
+  python3 tools/command_replay.py record --target http://192.168.1.100 --out session.jsonl
+
+  # Tekrar oynatma: 1x, 10x veya max hızda
+  python3 tools/command_replay.py replay session.jsonl --target http://192.168.1.100 --speed 10
+  python3 tools/command_replay.py replay session.jsonl --target http://localhost:8081 --speed max
+
+  # Yerel sahte sunucu (donanım olmadan aracı denemek için)
+  python3 tools/command_replay.py stub --port 8081
+
+Sadece Python standart kütüphanesi kullanılır.
+"""
+
+import argparse
+import json
+import sys
+import threading
+import time
+import urllib.error
+import urllib.parse
+import urllib.request
+from http.server import BaseHTTPRequestHandler, HTTPServer, ThreadingHTTPServer
+
+# Kaydedilen kontrol komutları (embedded UI'ın ürettiği istekler)
+COMMAND_PATHS = (
+    "/api/servo",
+    "/api/mosfet",
+    "/api/brake",
+    "/api/headlight",
+    "/api/stoplight",
+    "/api/lease",
+)
+
+# Tekrar oynatmada anlamsız olan parametreler (ts eski olacağı için 409 döner)
+DROP_PARAMS = ("ts",)
+
+HTTP_TIMEOUT = 2.0
+
+
+def strip_params(path):
+    """Yol içinden DROP_PARAMS parametrelerini çıkar."""
+    parsed = urllib.parse.urlsplit(path)
+    query = [(k, v) for k, v in urllib.parse.parse_qsl(parsed.query, keep_blank_values=True)
+             if k not in DROP_PARAMS]
+    return urllib.parse.urlunsplit(("", "", parsed.path, urllib.parse.urlencode(query), ""))
+
+
+def fetch(url):
+    """GET isteği at, (status, body, content_type) döner."""
+    try:
+        with urllib.request.urlopen(url, timeout=HTTP_TIMEOUT) as resp:
+            return resp.status, resp.read(), resp.headers.get("Content-Type")
+    except urllib.error.HTTPError as e:
+        return e.code, e.read(), e.headers.get("Content-Type")
+
+
+# ---------------------------------------------------------------------------
+# Kayıt (proxy)
+# ---------------------------------------------------------------------------
+
+def cmd_record(args):
+    target = args.target.rstrip("/")
+    out = open(args.out, "w", encoding="utf-8")
+    lock = threading.Lock()
+    start = time.monotonic()
+    count = [0]
+
+    class ProxyHandler(BaseHTTPRequestHandler):
+        def do_GET(self):
+            received = time.monotonic()
+            try:
+                status, body, content_type = fetch(target + self.path)
+            except (urllib.error.URLError, OSError) as e:
+                self.send_error(502, str(e))
+                return
+
+            if self.path.split("?", 1)[0] in COMMAND_PATHS:
+                entry = {
+                    "t": round(received - start, 6),
+                    "path": strip_params(self.path),
+                    "status": status,
+                }
+                with lock:
+                    out.write(json.dumps(entry) + "\n")
+                    out.flush()
+                    count[0] += 1
+
+            self.send_response(status)
+            if content_type:
+                self.send_header("Content-Type", content_type)
+            self.send_header("Content-Length", str(len(body)))
+            self.end_headers()
+            self.wfile.write(body)
+
+        def log_message(self, fmt, *a):
+            pass
+
+    server = ThreadingHTTPServer(("0.0.0.0", args.port), ProxyHandler)
+    print("Kayıt: http://localhost:%d -> %s (%s)" % (args.port, target, args.out))
+    print("Durdurmak için Ctrl+C")
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        server.server_close()
+        out.close()
+    print("\n%d komut kaydedildi" % count[0])
+    return 0
+
+
+# ---------------------------------------------------------------------------
+# Tekrar oynatma
+# ---------------------------------------------------------------------------
+
+def percentile(sorted_values, p):
+    if not sorted_values:
+        return 0.0
+    idx = min(len(sorted_values) - 1, int(round(p / 100.0 * (len(sorted_values) - 1))))
+    return sorted_values[idx]
+
+
+def read_stats(target, reset=False):
+    """Firmware /api/stats değerlerini oku (yoksa None)."""
+    try:
+        status, body, _ = fetch(target + "/api/stats" + ("?reset=1" if reset else ""))
+        if status == 200:
+            return json.loads(body)
+    except (urllib.error.URLError, OSError, ValueError):
+        pass
+    return None
+
+
+def load_session(path):
+    entries = []
+    with open(path, encoding="utf-8") as f:
+        for line in f:
+            line = line.strip()
+            if line:
+                entries.append(json.loads(line))
+    # Proxy çok iş parçacıklı; kayıtlar varış sırasından farklı yazılmış olabilir
+    entries.sort(key=lambda e: e["t"])
+    return entries
+
+
+def cmd_replay(args):
+    target = args.target.rstrip("/")
+    entries = load_session(args.session)
+    if not entries:
+        print("Oturum boş: %s" % args.session, file=sys.stderr)
+        return 1
+
+    speed = None if args.speed == "max" else float(args.speed)
+    if speed is not None and speed <= 0:
+        print("Geçersiz hız: %s" % args.speed, file=sys.stderr)
+        return 1
+
+    read_stats(target, reset=True)
+
+    latencies = []
+    errors = 0
+    statuses = {}
+    mismatches = {}  # (kayıttaki, tekrar oynatmadaki) durum kodu -> adet
+    max_lag = 0.0
+    t_first = entries[0]["t"]
+    t_span = entries[-1]["t"] - t_first
+
+    run_start = time.monotonic()
+    for loop in range(args.loops):
+        if speed is None:
+            start = time.monotonic()
+        else:
+            start = run_start + loop * t_span / speed
+        for entry in entries:
+            if speed is not None:
+                due = start + (entry["t"] - t_first) / speed
+                wait = due - time.monotonic()
+                if wait > 0:
+                    time.sleep(wait)
+                else:
+                    max_lag = max(max_lag, -wait)
+
+            sent = time.monotonic()
+            try:
+                status, _, _ = fetch(target + entry["path"])
+            except (urllib.error.URLError, OSError):
+                errors += 1
+                continue
+            latencies.append(time.monotonic() - sent)
+            statuses[status] = statuses.get(status, 0) + 1
+            recorded = entry.get("status")
+            if recorded is not None and recorded != status:
+                key = (recorded, status)
+                mismatches[key] = mismatches.get(key, 0) + 1
+
+    total_wall = time.monotonic() - run_start
+    stats = read_stats(target)
+
+    latencies.sort()
+    sent_total = len(latencies) + errors
+
+    print("Oturum        : %s (%d komut x %d)" % (args.session, len(entries), args.loops))
+    print("Hedef         : %s  hız: %s" % (target, args.speed))
+    print("Gönderilen    : %d  (hata: %d)" % (sent_total, errors))
+    print("Durum kodları : %s" % ", ".join("%d=%d" % kv for kv in sorted(statuses.items())))
+    if mismatches:
+        # Örn. lease başka sekmede tutuluyorsa 200 -> 423; sonuçlar geçerli bir ölçüm değildir
+        print("UYARI: kayıttan farklı durum: %d komut (%s)" % (
+            sum(mismatches.values()),
+            ", ".join("%d->%d=%d" % (r, p, n) for (r, p), n in sorted(mismatches.items()))))
+    if total_wall > 0:
+        print("Sürekli hız   : %.1f komut/s (%.2f s duvar süresi)" % (sent_total / total_wall, total_wall))
+    print("RTT (ms)      : p50=%.2f  p99=%.2f  p999=%.2f  max=%.2f (istemci, TCP bağlantısı dahil)" % (
+        percentile(latencies, 50) * 1000,
+        percentile(latencies, 99) * 1000,
+        percentile(latencies, 99.9) * 1000,
+        (latencies[-1] if latencies else 0) * 1000))
+    if speed is not None:
+        print("Zamanlama kayması: max %.1f ms" % (max_lag * 1000))
+    if stats:
+        print("Heap (byte)   : boş=%d  en düşük=%d  en büyük blok=%d  frag=%d%%" % (
+            stats.get("heap", 0), stats.get("heap_min", 0),
+            stats.get("max_block", 0), stats.get("frag", 0)))
+        print("Firmware      : %d komut işlendi" % stats.get("requests", 0))
+        if "handle_us_avg" in stats:
+            print("İşlenme (ms)  : ort=%.2f  max=%.2f (cihaz tarafı)" % (
+                stats["handle_us_avg"] / 1000.0, stats.get("handle_us_max", 0) / 1000.0))
+    else:
+        print("Heap          : /api/stats yok (hedef firmware değil)")
+    return 0 if errors == 0 and not mismatches else 2
+
+
+# ---------------------------------------------------------------------------
+# Yerel sahte sunucu
+# ---------------------------------------------------------------------------
+
+def cmd_stub(args):
+    # /api/stats bilerek yok: sahte sunucu heap ölçümü raporlamaz
+    state = {"headlight": False, "stoplight": False}
+
+    class StubHandler(BaseHTTPRequestHandler):
+        def do_GET(self):
+            path = self.path.split("?", 1)[0]
+            if path == "/api/headlight":
+                state["headlight"] = not state["headlight"]
+                body = "ON" if state["headlight"] else "OFF"
+            elif path == "/api/stoplight":
+                state["stoplight"] = not state["stoplight"]
+                body = "ON" if state["stoplight"] else "OFF"
+            elif path in COMMAND_PATHS:
+                body = "OK"
+            else:
+                self.send_error(404)
+                return
+            data = body.encode()
+            self.send_response(200)
+            self.send_header("Content-Length", str(len(data)))
+            self.end_headers()
+            self.wfile.write(data)
+
+        def log_message(self, fmt, *a):
+            pass
+
+    # Firmware gibi tek iş parçacıklı
+    server = HTTPServer(("127.0.0.1", args.port), StubHandler)
+    print("Sahte sunucu: http://127.0.0.1:%d" % args.port)
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        server.server_close()
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="RC Car komut kayıt/tekrar oynatma aracı")
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    p = sub.add_parser("record", help="Proxy üzerinden sürüş oturumunu kaydet")
+    p.add_argument("--target", required=True, help="Araç adresi (örn: http://192.168.1.100)")
+    p.add_argument("--port", type=int, default=8080, help="Proxy portu (varsayılan: 8080)")
+    p.add_argument("--out", default="session.jsonl", help="Kayıt dosyası")
+    p.set_defaults(func=cmd_record)
+
+    p = sub.add_parser("replay", help="Kaydedilmiş oturumu tekrar oynat")
+    p.add_argument("session", help="Kayıt dosyası (.jsonl)")
+    p.add_argument("--target", required=True, help="Hedef adres")
+    p.add_argument("--speed", default="1", help="Hız çarpanı: 1, 10, ... veya max")
+    p.add_argument("--loops", type=int, default=1, help="Oturumu kaç kez oynat")
+    p.set_defaults(func=cmd_replay)
+
+    p = sub.add_parser("stub", help="Yerel sahte RC Car sunucusu")
+    p.add_argument("--port", type=int, default=8081)
+    p.set_defaults(func=cmd_stub)
+
+    args = parser.parse_args()
+    return args.func(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())